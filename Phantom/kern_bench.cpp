@@ -0,0 +1,265 @@
+//
+//  kern_bench.cpp
+//  Phantom
+//
+//  Created by Carnations Botanica on 10/19/26.
+//
+
+#include "kern_bench.hpp"
+#include "kern_vmm.hpp"
+#include "kern_kextmanager.hpp"
+#include "kern_ioreg.hpp"
+#include <sys/kauth.h>
+#include <kern/clock.h>
+
+// Only one benchmark may run at a time
+static volatile UInt32 benchRunning = 0;
+
+// Keeps the compiler from dropping the benchmarked calls
+static volatile uint64_t benchSink = 0;
+
+// Synthetic process names, a mix of targeted and untargeted ones
+static const char *syntheticProcNames[] = {
+	"LeagueClient",
+	"launchd",
+	"RiotClientServic",
+	"WindowServer",
+	"softwareupdated",
+	"kernel_task",
+	"LeagueClientUx H",
+	"Safari"
+};
+
+// Synthetic IORegistry property keys, only "manufacturer" is spoofed
+static const char *syntheticKeyNames[] = {
+	"manufacturer",
+	"model",
+	"IOName",
+	"vendor-id"
+};
+
+// Synthetic bundle ID prefixes for the KMP dictionary, every other one gets filtered
+static const char *syntheticBundlePrefixes[] = {
+	"com.apple.driver.Synthetic",
+	"org.acidanthera.Synthetic",
+	"com.apple.iokit.Synthetic",
+	"as.vit9696.Synthetic"
+};
+
+// qsort comparator for timing samples
+static int compareSamples(const void *a, const void *b) {
+	uint64_t lhs = *static_cast<const uint64_t *>(a);
+	uint64_t rhs = *static_cast<const uint64_t *>(b);
+	return (lhs > rhs) - (lhs < rhs);
+}
+
+// Smallest cost of a back-to-back mach_absolute_time() pair, subtracted from every sample
+static uint64_t calibrateTimerOverhead() {
+	uint64_t overhead = UINT64_MAX;
+	for (uint32_t i = 0; i < 1024; ++i) {
+		uint64_t start = mach_absolute_time();
+		uint64_t delta = mach_absolute_time() - start;
+		if (delta < overhead) {
+			overhead = delta;
+		}
+	}
+	return overhead;
+}
+
+// Time the whole loop once for ns/op, then time every iteration individually for the percentiles
+template <typename T>
+static void measurePath(PHTMBenchPath &path, const char *name, uint32_t iterations, uint64_t *samples, uint64_t timerOverhead, T op) {
+
+	strlcpy(path.name, name, sizeof(path.name));
+	path.iterations = iterations;
+
+	// No per-iteration timer calls here, cheap paths would otherwise mostly measure the timer
+	uint64_t loopStart = mach_absolute_time();
+	for (uint32_t i = 0; i < iterations; ++i) {
+		op(i);
+	}
+	uint64_t total = 0;
+	absolutetime_to_nanoseconds(mach_absolute_time() - loopStart, &total);
+	path.nsPerOp = total / iterations;
+
+	for (uint32_t i = 0; i < iterations; ++i) {
+		uint64_t start = mach_absolute_time();
+		op(i);
+		uint64_t delta = mach_absolute_time() - start;
+		samples[i] = delta > timerOverhead ? delta - timerOverhead : 0;
+	}
+
+	for (uint32_t i = 0; i < iterations; ++i) {
+		absolutetime_to_nanoseconds(samples[i], &samples[i]);
+	}
+
+	qsort(samples, iterations, sizeof(samples[0]), compareSamples);
+	path.p50 = samples[(iterations - 1) * 50 / 100];
+	path.p90 = samples[(iterations - 1) * 90 / 100];
+	path.p99 = samples[(iterations - 1) * 99 / 100];
+	path.max = samples[iterations - 1];
+
+	DBGLOG(MODULE_BENCH, "%s: %llu ns/op over %u iterations (p50 %llu, p90 %llu, p99 %llu, max %llu)", path.name, path.nsPerOp, path.iterations, path.p50, path.p90, path.p99, path.max);
+}
+
+// Build a dictionary shaped like the one OSKext::copyLoadedKextInfo returns
+static OSDictionary *createSyntheticKextInfo(uint32_t dictSize) {
+
+	OSDictionary *dict = OSDictionary::withCapacity(dictSize);
+	if (!dict) {
+		return nullptr;
+	}
+
+	const size_t numPrefixes = sizeof(syntheticBundlePrefixes) / sizeof(syntheticBundlePrefixes[0]);
+	char bundleID[64];
+	for (uint32_t i = 0; i < dictSize; ++i) {
+		snprintf(bundleID, sizeof(bundleID), "%s%u", syntheticBundlePrefixes[i % numPrefixes], i);
+		const OSSymbol *key = OSSymbol::withCString(bundleID);
+		if (!key) {
+			dict->release();
+			return nullptr;
+		}
+		dict->setObject(key, kOSBooleanTrue);
+		key->release();
+	}
+
+	return dict;
+}
+
+// Run every decision path against synthetic inputs
+int BENCH::run(const PHTMBenchRequest &request, PHTMBenchResult &result) {
+
+	uint32_t iterations = request.iterations ? request.iterations : PHTM_BENCH_DEFAULT_ITERATIONS;
+	uint32_t dictSize = request.dictSize ? request.dictSize : PHTM_BENCH_DEFAULT_DICT_SIZE;
+	if (iterations > PHTM_BENCH_MAX_ITERATIONS || dictSize > PHTM_BENCH_MAX_DICT_SIZE) {
+		DBGLOG(MODULE_BENCH, "Rejecting benchmark request (iterations: %u, dictSize: %u).", iterations, dictSize);
+		return EINVAL;
+	}
+
+	bzero(&result, sizeof(result));
+	result.version = PHTM_BENCH_VERSION;
+	result.iterations = iterations;
+	result.dictSize = dictSize;
+	result.pathCount = PHTMBenchPathCount;
+
+	// Prepare all synthetic inputs up front so they stay out of the timings
+	size_t samplesSize = iterations * sizeof(uint64_t);
+	uint64_t *samples = static_cast<uint64_t *>(IOMalloc(samplesSize));
+	OSDictionary *kextInfo = createSyntheticKextInfo(dictSize);
+	const size_t numKeys = sizeof(syntheticKeyNames) / sizeof(syntheticKeyNames[0]);
+	const OSSymbol *keys[numKeys] = {};
+	bool keysReady = true;
+	for (size_t i = 0; i < numKeys; ++i) {
+		keys[i] = OSSymbol::withCString(syntheticKeyNames[i]);
+		keysReady = keysReady && keys[i];
+	}
+
+	int error = 0;
+	if (!samples || !kextInfo || !keysReady) {
+		DBGLOG(MODULE_ERROR, "Failed to allocate synthetic benchmark inputs.");
+		error = ENOMEM;
+	} else {
+		const size_t numProcNames = sizeof(syntheticProcNames) / sizeof(syntheticProcNames[0]);
+		const uint64_t timerOverhead = calibrateTimerOverhead();
+		
+		// Keep the bundle filter within its work budget, measurePath runs every op twice
+		uint64_t kmpIterations = PHTM_BENCH_KMP_WORK_BUDGET / (2 * static_cast<uint64_t>(dictSize) * dictSize);
+		kmpIterations = kmpIterations < 1 ? 1 : (kmpIterations > iterations ? iterations : kmpIterations);
+		DBGLOG(MODULE_BENCH, "Running %u iterations per path (%llu for bundle-filter), KMP dictionary size %u.", iterations, kmpIterations, dictSize);
+
+		// Process classification, as done by every IOR hook
+		measurePath(result.paths[PHTMBenchProcClassify], "proc-classify", iterations, samples, timerOverhead, [&](uint32_t i) {
+			benchSink = benchSink + IOR::isProcFiltered(syntheticProcNames[i % numProcNames]);
+		});
+
+		// Property key match for a targeted process
+		measurePath(result.paths[PHTMBenchKeyMatch], "key-match", iterations, samples, timerOverhead, [&](uint32_t i) {
+			benchSink = benchSink + IOR::isSpoofedKey(keys[i % numKeys]);
+		});
+
+		// Bundle ID filter over the synthetic copyLoadedKextInfo dictionary
+		measurePath(result.paths[PHTMBenchBundleFilter], "bundle-filter", static_cast<uint32_t>(kmpIterations), samples, timerOverhead, [&](uint32_t) {
+			OSDictionary *filtered = KMP::filterLoadedKextInfo(kextInfo, MODULE_BENCH, 0, false, nullptr);
+			if (filtered) {
+				benchSink = benchSink + filtered->getCount();
+				filtered->release();
+			}
+		});
+
+		// Sysctl handler body without the copyout, including the current process lookup
+		measurePath(result.paths[PHTMBenchSysctlHandler], "sysctl-handler", iterations, samples, timerOverhead, [&](uint32_t) {
+			char procName[MAX_PROC_NAME_LEN] = {0};
+			proc_name(proc_pid(current_proc()), procName, sizeof(procName));
+			benchSink = benchSink + VMM::presentValueForProc(procName);
+		});
+	}
+
+	for (size_t i = 0; i < numKeys; ++i) {
+		if (keys[i]) {
+			keys[i]->release();
+		}
+	}
+	OSSafeReleaseNULL(kextInfo);
+	if (samples) {
+		IOFree(samples, samplesSize);
+	}
+
+	return error;
+}
+
+// Phantom's debug.kpibench sysctl, takes an optional PHTMBenchRequest and returns a PHTMBenchResult
+static int phtm_sysctl_bench(struct sysctl_oid *oidp, void *arg1, int arg2, struct sysctl_req *req) {
+
+	// Benchmarks are for administrators only, reading included
+	if (!kauth_cred_issuser(kauth_cred_get())) {
+		return EPERM;
+	}
+
+	// Size query, do not run anything
+	if (req->oldptr == USER_ADDR_NULL) {
+		return SYSCTL_OUT(req, nullptr, sizeof(PHTMBenchResult));
+	}
+
+	PHTMBenchRequest request = {};
+	if (req->newptr != USER_ADDR_NULL) {
+		if (req->newlen != sizeof(request)) {
+			return EINVAL;
+		}
+		int error = SYSCTL_IN(req, &request, sizeof(request));
+		if (error) {
+			return error;
+		}
+	}
+
+	if (!OSCompareAndSwap(0, 1, &benchRunning)) {
+		DBGLOG(MODULE_SBENCH, "A benchmark is already running.");
+		return EBUSY;
+	}
+
+	PHTMBenchResult result;
+	int error = BENCH::run(request, result);
+	OSCompareAndSwap(1, 0, &benchRunning);
+	if (error) {
+		return error;
+	}
+
+	return SYSCTL_OUT(req, &result, sizeof(result));
+}
+
+// debug.kpibench, named so that it does not point back at Phantom
+SYSCTL_PROC(_debug, OID_AUTO, kpibench, CTLTYPE_OPAQUE | CTLFLAG_RW | CTLFLAG_LOCKED, nullptr, 0, phtm_sysctl_bench, "S,PHTMBenchResult", "");
+
+// Function for the BENCH init routine
+void BENCH::init() {
+    DBGLOG(MODULE_BENCH, "BENCH::init() called. BENCH module is starting.");
+
+	// Opt-in only, the sysctl must not exist on regular boots
+	if (!checkKernelArgument(PHTM_BENCH_BOOTARG)) {
+		DBGLOG(MODULE_BENCH, "%s not set, debug.kpibench will not be registered.", PHTM_BENCH_BOOTARG);
+		return;
+	}
+
+	sysctl_register_oid(&sysctl__debug_kpibench);
+
+	DBGLOG(MODULE_INFO, "debug.kpibench registered successfully.");
+}
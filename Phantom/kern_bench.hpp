@@ -0,0 +1,112 @@
+//
+//  kern_bench.hpp
+//  Phantom
+//
+//  Created by Carnations Botanica on 10/19/26.
+//
+
+#ifndef kern_bench_hpp
+#define kern_bench_hpp
+
+// Include Parent Module
+#include "kern_start.hpp"
+#include <stddef.h>
+
+// Logging Defs
+#define MODULE_BENCH "BENCH"
+#define MODULE_SBENCH "SBENCH"
+
+/**
+ * The benchmark sysctl is only registered when booted with this argument,
+ * an unconditional entry would be one more way to detect Phantom.
+ */
+#define PHTM_BENCH_BOOTARG "-phtmbench"
+
+/**
+ * Layout shared with userspace through the debug.kpibench sysctl.
+ * Tools/test-vmm mirrors these structs, the static_asserts below pin the layout.
+ */
+#define PHTM_BENCH_VERSION 2
+#define PHTM_BENCH_PATH_NAME_LEN 16
+#define PHTM_BENCH_DEFAULT_ITERATIONS 10000
+#define PHTM_BENCH_MAX_ITERATIONS 100000
+#define PHTM_BENCH_DEFAULT_DICT_SIZE 256
+#define PHTM_BENCH_MAX_DICT_SIZE 4096
+
+/**
+ * Each bundle-filter op builds a dictionary of up to dictSize entries. XNU's OSDictionary::setObject
+ * scans the existing keys, so one op is counted as dictSize^2 units of work. measurePath runs every
+ * op twice (timed loop and sampled pass), so bundle-filter iterations are capped at
+ * budget / (2 * dictSize^2), keeping the total work of that path at or below this budget.
+ */
+#define PHTM_BENCH_KMP_WORK_BUDGET (1ULL << 26)
+
+// Optional input, written as the new value of debug.kpibench
+struct PHTMBenchRequest {
+	uint32_t iterations;
+	uint32_t dictSize;
+};
+
+// Timings for a single decision path, all values are in nanoseconds
+struct PHTMBenchPath {
+	char name[PHTM_BENCH_PATH_NAME_LEN];
+	uint32_t iterations;
+	uint32_t reserved;
+	uint64_t nsPerOp;
+	uint64_t p50;
+	uint64_t p90;
+	uint64_t p99;
+	uint64_t max;
+};
+
+// Benchmarked decision paths, in the order they are reported
+enum PHTMBenchPathIndex {
+	PHTMBenchProcClassify,
+	PHTMBenchKeyMatch,
+	PHTMBenchBundleFilter,
+	PHTMBenchSysctlHandler,
+	PHTMBenchPathCount
+};
+
+// Output, read as the old value of debug.kpibench
+struct PHTMBenchResult {
+	uint32_t version;
+	uint32_t iterations;
+	uint32_t dictSize;
+	uint32_t pathCount;
+	PHTMBenchPath paths[PHTMBenchPathCount];
+};
+
+// Must match the copy in Tools/test-vmm/test-vmm.c
+static_assert(sizeof(PHTMBenchRequest) == 8, "PHTMBenchRequest layout changed");
+static_assert(sizeof(PHTMBenchPath) == 64, "PHTMBenchPath layout changed");
+static_assert(offsetof(PHTMBenchPath, iterations) == 16, "PHTMBenchPath layout changed");
+static_assert(offsetof(PHTMBenchPath, nsPerOp) == 24, "PHTMBenchPath layout changed");
+static_assert(offsetof(PHTMBenchPath, max) == 56, "PHTMBenchPath layout changed");
+static_assert(PHTMBenchPathCount == 4, "PHTMBenchResult layout changed");
+static_assert(offsetof(PHTMBenchResult, paths) == 16, "PHTMBenchResult layout changed");
+static_assert(sizeof(PHTMBenchResult) == 272, "PHTMBenchResult layout changed");
+
+// Self-Benchmark Class
+class BENCH {
+public:
+
+	/**
+	 * @brief Registers the privileged debug.kpibench sysctl when booted with PHTM_BENCH_BOOTARG.
+	 * Runs every hook decision path in-kernel against synthetic inputs when read.
+	 */
+	static void init();
+
+	/**
+	 * @brief Runs all benchmarks with the given request and fills in result.
+	 * @return 0 on success, or an errno value.
+	 */
+	static int run(const PHTMBenchRequest &request, PHTMBenchResult &result);
+
+private:
+
+	// None at the moment
+
+};
+
+#endif /* kern_bench_hpp */
@@ -31,7 +31,7 @@ const char *IOR::filteredClasses[] = {
 };
 
 // Generic isProcFiltered Helper Function
-static bool isProcFiltered(const char *procName) {
+bool IOR::isProcFiltered(const char *procName) {
     if (!procName) {
         return false;
     }
@@ -44,6 +44,15 @@ static bool isProcFiltered(const char *procName) {
     return false;
 }
 
+// Property key match, currently only "manufacturer" is spoofed
+bool IOR::isSpoofedKey(const OSSymbol *aKey) {
+    if (!aKey) {
+        return false;
+    }
+    const char *keyName = aKey->getCStringNoCopy();
+    return keyName && strcmp(keyName, "manufacturer") == 0;
+}
+
 // Forward declaration for our main hook
 OSObject *phtm_IORegistryEntry_getProperty_os_symbol(const IORegistryEntry *that, const OSSymbol *aKey);
 
@@ -75,12 +84,10 @@ OSObject *phtm_IORegistryEntry_getProperty_os_symbol(const IORegistryEntry *that
     proc_name(pid, procName, sizeof(procName));
 
     // Check if the process is one we want to target.
-    if (isProcFiltered(procName))
+    if (IOR::isProcFiltered(procName))
     {
-        const char *keyName = aKey->getCStringNoCopy();
-
         // If the key is "manufacturer", spoof it.
-        if (keyName && strcmp(keyName, "manufacturer") == 0)
+        if (IOR::isSpoofedKey(aKey))
         {
             const char* entryClassName = that->getMetaClass()->getClassName();
             const char* spoofedValue = "Apple Inc.";
@@ -45,6 +45,12 @@ public:
 	// Array of IORegistry class names to hide from filtered processes
     static const char *filteredClasses[];
 	
+	// Returns whether the given process name is one we target
+	static bool isProcFiltered(const char *procName);
+	
+	// Returns whether the given property key is one we spoof for targeted processes
+	static bool isSpoofedKey(const OSSymbol *aKey);
+	
 	// Function pointer types for the original kernel functions
     // Note: The methods we are hooking are const, so the 'this' pointer is const IORegistryEntry*
     using _IORegistryEntry_getProperty_t = OSObject * (*)(const IORegistryEntry *that, const OSSymbol *aKey);
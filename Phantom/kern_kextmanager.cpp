@@ -10,6 +10,91 @@
 // Pointer to original declaration
 static KMP::_OSKext_copyLoadedKextInfo_t original_OSKext_copyLoadedKextInfo = nullptr;
 
+// Bundle ID substrings of the kexts we hide from copyLoadedKextInfo
+static const char *filterSubstrings[] = {
+	"org.Carnations",
+	"org.acidanthera",
+	"ru.usrsse2",
+	"ru.joedm",
+	"com.dhinakg",
+	"com.zxystd",
+	"org.Chefkiss",
+	"com.github.whatdahopper",
+	"com.insanelymac",
+	"com.alexandred",
+	"org.coolstar",
+	"com.1Revenger1",
+	"me.kishorprins",
+	"as.vit9696",
+	"com.sn-labs"
+};
+
+// Copy originalDict into a new dictionary, leaving out every kext matching filterSubstrings
+OSDictionary *KMP::filterLoadedKextInfo(OSDictionary *originalDict, const char *procName, pid_t procPid, bool logMatches, unsigned int *removedCount) {
+
+	unsigned int originalCount = originalDict->getCount();
+
+	// Create a new dictionary to store the filtered results.
+	// OSDictionary::withCapacity returns an object with a retain count of 1.
+	OSDictionary *filteredDict = OSDictionary::withCapacity(originalCount > 0 ? originalCount -1 : 0); // Estimate capacity
+
+	if (!filteredDict) {
+		DBGLOG(MODULE_CLKI, "Failed to allocate filteredDict for '%s' (PID: %d).", procName, procPid);
+		return nullptr;
+	}
+
+	unsigned int removed = 0;
+	unsigned int numFilters = sizeof(filterSubstrings) / sizeof(filterSubstrings[0]);
+	OSCollectionIterator *iter = OSCollectionIterator::withCollection(originalDict);
+	if (iter) {
+		OSObject *keyObject;
+		while ((keyObject = iter->getNextObject())) {
+			OSString *bundleID = OSDynamicCast(OSString, keyObject); // Keys are bundle IDs (OSString)
+			if (bundleID) {
+				OSObject *value = originalDict->getObject(bundleID); // Get the associated kext info
+
+				if (value) { // Should always be true if keyObject is valid
+					const char *bundleIDCStr = bundleID->getCStringNoCopy();
+					bool shouldFilterThisKext = false;
+					const char *matchedFilter = nullptr;
+
+					if (bundleIDCStr) { // Ensure C-string is valid
+						for (unsigned int i = 0; i < numFilters; ++i) {
+							if (strstr(bundleIDCStr, filterSubstrings[i]) != nullptr) {
+								shouldFilterThisKext = true;
+								matchedFilter = filterSubstrings[i];
+								break;
+							}
+						}
+					}
+
+					if (shouldFilterThisKext) {
+						if (logMatches) {
+							DBGLOG(MODULE_CLKI, "Filtering out kext: %s (filter match: '%s') for '%s' (PID: %d).", bundleIDCStr ? bundleIDCStr : "UnknownBundleID", matchedFilter, procName, procPid);
+						}
+						removed++;
+					} else {
+						// This kext should be included. Add it to the filtered dictionary.
+						// filteredDict->setObject retains both key and value.
+						filteredDict->setObject(bundleID, value);
+					}
+				}
+			}
+		}
+		iter->release(); // Release the iterator
+	} else {
+		DBGLOG(MODULE_CLKI, "Failed to create iterator for originalDict for '%s' (PID: %d).", procName, procPid);
+		filteredDict->release(); // Release the empty filteredDict we allocated
+		return nullptr;
+	} // we couldn't modify the dict, something went wrong, let the caller fall back
+
+	if (removedCount) {
+		*removedCount = removed;
+	}
+	return filteredDict;
+
+}
+
 // Phantom's custom OSKext::copyLoadedKextInfo function, which cleanses the dict from 3rd party extensions
 OSDictionary *phtm_OSKext_copyLoadedKextInfo(OSArray *kextIdentifiers, OSArray *bundlePaths) {
 
@@ -30,76 +115,13 @@ OSDictionary *phtm_OSKext_copyLoadedKextInfo(OSArray *kextIdentifiers, OSArray *
 			unsigned int originalCount = originalDict->getCount();
 			DBGLOG(MODULE_CLKI, "Original function returned a dictionary with %u entries for '%s' (PID: %d).", originalCount, procName, procPid);
 
-			// Create a new dictionary to store the filtered results.
-			// OSDictionary::withCapacity returns an object with a retain count of 1.
-			OSDictionary *filteredDict = OSDictionary::withCapacity(originalCount > 0 ? originalCount -1 : 0); // Estimate capacity
-
+			unsigned int removedCount = 0;
+			OSDictionary *filteredDict = KMP::filterLoadedKextInfo(originalDict, procName, procPid, true, &removedCount);
 			if (!filteredDict) {
-				DBGLOG(MODULE_CLKI, "Failed to allocate filteredDict for '%s' (PID: %d). Returning original (unmodified) dictionary.", procName, procPid);
-				return originalDict;
+				DBGLOG(MODULE_CLKI, "Returning original (unmodified) dictionary for '%s' (PID: %d).", procName, procPid);
+				return originalDict; // Return the originalDict (already retained)
 			}
 
-			unsigned int removedCount = 0;
-			const char *filterSubstrings[] = {
-				"org.Carnations",
-				"org.acidanthera",
-				"ru.usrsse2",
-				"ru.joedm",
-				"com.dhinakg",
-				"com.zxystd",
-				"org.Chefkiss",
-				"com.github.whatdahopper",
-				"com.insanelymac",
-				"com.alexandred",
-				"org.coolstar",
-				"com.1Revenger1",
-				"me.kishorprins",
-				"as.vit9696",
-				"com.sn-labs"
-			};
-
-			unsigned int numFilters = sizeof(filterSubstrings) / sizeof(filterSubstrings[0]);
-			OSCollectionIterator *iter = OSCollectionIterator::withCollection(originalDict);
-			if (iter) {
-				OSObject *keyObject;
-				while ((keyObject = iter->getNextObject())) {
-					OSString *bundleID = OSDynamicCast(OSString, keyObject); // Keys are bundle IDs (OSString)
-					if (bundleID) {
-						OSObject *value = originalDict->getObject(bundleID); // Get the associated kext info
-
-						if (value) { // Should always be true if keyObject is valid
-							const char *bundleIDCStr = bundleID->getCStringNoCopy();
-							bool shouldFilterThisKext = false;
-							const char *matchedFilter = nullptr;
-
-							if (bundleIDCStr) { // Ensure C-string is valid
-								for (unsigned int i = 0; i < numFilters; ++i) {
-									if (strstr(bundleIDCStr, filterSubstrings[i]) != nullptr) {
-										shouldFilterThisKext = true;
-										matchedFilter = filterSubstrings[i];
-										break;
-									}
-								}
-							}
-
-							if (shouldFilterThisKext) {
-								DBGLOG(MODULE_CLKI, "Filtering out kext: %s (filter match: '%s') for '%s' (PID: %d).", bundleIDCStr ? bundleIDCStr : "UnknownBundleID", matchedFilter, procName, procPid);
-								removedCount++;
-							} else {
-								// This kext should be included. Add it to the filtered dictionary.
-								// filteredDict->setObject retains both key and value.
-								filteredDict->setObject(bundleID, value);
-							}
-						}
-					}
-				}
-				iter->release(); // Release the iterator
-			} else {
-				DBGLOG(MODULE_CLKI, "Failed to create iterator for originalDict for '%s' (PID: %d). Returning original (unmodified) dictionary.", procName, procPid);
-				filteredDict->release(); // Release the empty filteredDict we allocated
-				return originalDict;     // Return the originalDict (already retained)
-			} // we couldn't modify the dict, something went wrong, return the og dict
-
 			unsigned int filteredCount = filteredDict->getCount();
 			DBGLOG(MODULE_CLKI, "Original dict had %u entries. Returning modified dict with %u entries (%u removed) for '%s' (PID: %d).", originalCount, filteredCount, removedCount, procName, procPid);
 			originalDict->release();
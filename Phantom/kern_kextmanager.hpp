@@ -26,6 +26,17 @@ public:
 	// Function pointer type for the original kernel functions
     using _OSKext_copyLoadedKextInfo_t = OSDictionary *(*)(OSArray *kextIdentifiers, OSArray *bundlePaths);
 	
+	/**
+	 * @brief Builds a copy of a copyLoadedKextInfo dictionary without 3rd party bundle IDs.
+	 * @param originalDict Dictionary to filter, it is not released.
+	 * @param procName Name of the calling process, only used for logging.
+	 * @param procPid PID of the calling process, only used for logging.
+	 * @param logMatches Whether to log every filtered kext.
+	 * @param removedCount Optional, receives the number of filtered kexts.
+	 * @return A new retained dictionary, or nullptr if it could not be built.
+	 */
+	static OSDictionary *filterLoadedKextInfo(OSDictionary *originalDict, const char *procName, pid_t procPid, bool logMatches, unsigned int *removedCount);
+	
 private:
 	
 	// None at the moment
@@ -11,6 +11,7 @@
 #include "kern_securelevel.hpp"
 // #include "kern_csr.hpp"
 #include "kern_ioreg.hpp"
+#include "kern_bench.hpp"
 
 static PHTM phtmInstance;
 PHTM *PHTM::callbackPHTM;
@@ -60,6 +61,11 @@ static bool readNvramVariable(const char *fullName, const char16_t *unicodeName,
 	return false;
 }
 
+// Report how long a single init stage took, debug builds only
+static void reportStage(const char *name, uint64_t startNs) {
+	DBGLOG(MODULE_STAGE, "Stage '%s' ready in %llu us.", name, (getCurrentTimeNs() - startNs) / 1000);
+}
+
 // Function to get _sysctl__children memory address
 mach_vm_address_t PHTM::sysctlChildrenAddr(KernelPatcher &patcher) {
 	
@@ -94,6 +100,8 @@ mach_vm_address_t PHTM::sysctlChildrenAddr(KernelPatcher &patcher) {
 void PHTM::solveSysCtlChildrenAddr(void *user __unused, KernelPatcher &Patcher) {
     DBGLOG(MODULE_SSYSCTL, "PHTM::solveSysCtlChildrenAddr called successfully. Attempting to resolve and store _sysctl__children address.");
 	
+	uint64_t routineStartNs = getCurrentTimeNs();
+	uint64_t stageStartNs = routineStartNs;
     PHTM::gSysctlChildrenAddr = PHTM::sysctlChildrenAddr(Patcher);
 	
     if (PHTM::gSysctlChildrenAddr) {
@@ -102,7 +110,9 @@ void PHTM::solveSysCtlChildrenAddr(void *user __unused, KernelPatcher &Patcher)
         DBGLOG(MODULE_SSYSCTL, "Failed to resolve _sysctl__children address. PHTM::gSysctlChildrenAddr is NULL.");
 		panic(MODULE_LONG, "Failed to resolve _sysctl__children address. PHTM::gSysctlChildrenAddr is NULL.");
     }
+	reportStage("sysctl", stageStartNs);
 	
+	stageStartNs = getCurrentTimeNs();
 
 	bool initializeVMM = true;
 	char revpatchValue[256] = {0};
@@ -121,6 +131,7 @@ void PHTM::solveSysCtlChildrenAddr(void *user __unused, KernelPatcher &Patcher)
 			DBGLOG(MODULE_INIT, "Found 'sbvmm' in 'revpatch' setting, VMM module will be skipped.");
 		}
 	}
+	reportStage("revpatch", stageStartNs);
 	
     // Begin routine selection based on kernel version.
     DBGLOG(MODULE_INIT, "Performing OS-specific reroutes...");
@@ -132,17 +143,25 @@ void PHTM::solveSysCtlChildrenAddr(void *user __unused, KernelPatcher &Patcher)
         
         if (initializeVMM) {
             DBGLOG(MODULE_INIT, "Initializing VMM module.");
+            stageStartNs = getCurrentTimeNs();
             VMM::init(Patcher);
+            reportStage("VMM", stageStartNs);
         }
         
         DBGLOG(MODULE_INIT, "Initializing KMP module.");
+        stageStartNs = getCurrentTimeNs();
         KMP::init(Patcher);
+        reportStage("KMP", stageStartNs);
         
         DBGLOG(MODULE_INIT, "Initializing SLP module.");
+        stageStartNs = getCurrentTimeNs();
         SLP::init(Patcher);
+        reportStage("SLP", stageStartNs);
         
         DBGLOG(MODULE_INIT, "Initializing IOR module.");
+        stageStartNs = getCurrentTimeNs();
         IOR::init(Patcher);
+        reportStage("IOR", stageStartNs);
 
     // For supported versions up to and including Big Sur.
     } else if (PHTM::darwinMajor >= KernelVersion::HighSierra) {
@@ -150,13 +169,19 @@ void PHTM::solveSysCtlChildrenAddr(void *user __unused, KernelPatcher &Patcher)
         DBGLOG(MODULE_INIT, "Detected a supported legacy macOS version (High Sierra - Big Sur).");
 		
         DBGLOG(MODULE_INIT, "Initializing KMP module.");
+        stageStartNs = getCurrentTimeNs();
         KMP::init(Patcher);
+        reportStage("KMP", stageStartNs);
         
         DBGLOG(MODULE_INIT, "Initializing SLP module.");
+        stageStartNs = getCurrentTimeNs();
         SLP::init(Patcher);
+        reportStage("SLP", stageStartNs);
         
         DBGLOG(MODULE_INIT, "Initializing IOR module.");
+        stageStartNs = getCurrentTimeNs();
         IOR::init(Patcher);
+        reportStage("IOR", stageStartNs);
         
     // Unsupported older versions.
     } else {
@@ -164,6 +189,11 @@ void PHTM::solveSysCtlChildrenAddr(void *user __unused, KernelPatcher &Patcher)
         panic(MODULE_LONG, "Detected an unsupported version of macOS (older than High Sierra).");
     }
 	
+	// Self-benchmark sysctl, only registered when booted with -phtmbench.
+	DBGLOG(MODULE_INIT, "Initializing BENCH module.");
+	BENCH::init();
+	
+	reportStage("onPatcherLoadForce", routineStartNs);
     DBGLOG(MODULE_SSYSCTL, "Finished all reroute attempts.");
 }
 
@@ -17,6 +17,7 @@
 #include <Headers/kern_api.hpp>
 #include <Headers/kern_util.hpp>
 #include <Headers/kern_mach.hpp>
+#include <Headers/kern_time.hpp>
 #include <mach/i386/vm_types.h>
 #include <libkern/libkern.h>
 #include <IOKit/IOLib.h>
@@ -36,6 +37,7 @@
 #define MODULE_PPU "PPU"
 #define MODULE_SYSCA "SYSCA"
 #define MODULE_SSYSCTL "SSYSCTL"
+#define MODULE_STAGE "STAGE"
 
 // PHTM Root/Parent Class
 class PHTM {
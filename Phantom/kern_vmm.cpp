@@ -25,18 +25,13 @@ const PHTM::DetectedProcess VMM::filteredProcs[] = {
     {"osinstallersetup", -1}
 };
 
-// Phantom's custom sysctl VMM present function
-int phtm_sysctl_vmm_present(struct sysctl_oid *oidp, void *arg1, int arg2, struct sysctl_req *req) {
-    
-    // Retrieve the current process information
-    proc_t currentProcess = current_proc();
-    pid_t procPid = proc_pid(currentProcess);
-    char procName[MAX_PROC_NAME_LEN] = {0};
-    proc_name(procPid, procName, sizeof(procName));
+// Decision path for kern.hv_vmm_present, kept separate from the handler so it can be benchmarked
+int VMM::presentValueForProc(const char *procName) {
     
     // Default to 0 (VMM not present). This will be the value for any process NOT in our list.
-    int value_to_return = 0;
-    bool isFiltered = false;
+    if (!procName) {
+        return 0;
+    }
 
     // Determine the number of processes in our filter list
     const size_t num_filtered = sizeof(VMM::filteredProcs) / sizeof(VMM::filteredProcs[0]);
@@ -45,15 +40,28 @@ int phtm_sysctl_vmm_present(struct sysctl_oid *oidp, void *arg1, int arg2, struc
     for (size_t i = 0; i < num_filtered; ++i) {
         // Use strcmp to compare the current process name with the name in our list
         if (strcmp(procName, VMM::filteredProcs[i].name) == 0) {
-            // Match found! Set the return value to 1 (VMM is present).
-            value_to_return = 1;
-            isFiltered = true;
-            break; // Exit the loop since we found our match
+            // Match found! Report VMM as present.
+            return 1;
         }
     }
+    
+    return 0;
+}
+
+// Phantom's custom sysctl VMM present function
+int phtm_sysctl_vmm_present(struct sysctl_oid *oidp, void *arg1, int arg2, struct sysctl_req *req) {
+    
+    // Retrieve the current process information
+    proc_t currentProcess = current_proc();
+    pid_t procPid = proc_pid(currentProcess);
+    char procName[MAX_PROC_NAME_LEN] = {0};
+    proc_name(procPid, procName, sizeof(procName));
+    
+    // Only processes on our list see a VMM
+    int value_to_return = VMM::presentValueForProc(procName);
 
     // Log the action for debugging purposes
-    if (isFiltered) {
+    if (value_to_return) {
         DBGLOG(MODULE_CVMM, "Process '%s' (PID: %d) is on the filter list. Reporting hv_vmm_present as %d.", procName, procPid, value_to_return);
     } else {
         DBGLOG(MODULE_CVMM, "Process '%s' (PID: %d) is NOT on the filter list. Reporting hv_vmm_present as %d.", procName, procPid, value_to_return);
@@ -34,6 +34,9 @@ public:
 	
 	// is Process in Filter Tracker
 	static bool isProcFiltered;
+	
+	// Decision path for kern.hv_vmm_present, returns the value reported to the given process
+	static int presentValueForProc(const char *procName);
 
 private:
 	
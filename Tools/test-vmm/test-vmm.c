@@ -10,8 +10,96 @@
 #include <string.h>
 #include <sys/sysctl.h> // Required for sysctlbyname
 #include <errno.h>      // Required for errno
+#include <stdint.h>
+#include <stddef.h>
+
+// Mirrors the debug.kpibench layout in Phantom/kern_bench.hpp, both sides assert the same sizes
+#define PHTM_BENCH_VERSION 2
+#define PHTM_BENCH_PATH_NAME_LEN 16
+#define PHTM_BENCH_PATH_COUNT 4
+
+struct PHTMBenchRequest {
+    uint32_t iterations;
+    uint32_t dictSize;
+};
+
+struct PHTMBenchPath {
+    char name[PHTM_BENCH_PATH_NAME_LEN];
+    uint32_t iterations;
+    uint32_t reserved;
+    uint64_t nsPerOp;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t max;
+};
+
+struct PHTMBenchResult {
+    uint32_t version;
+    uint32_t iterations;
+    uint32_t dictSize;
+    uint32_t pathCount;
+    struct PHTMBenchPath paths[PHTM_BENCH_PATH_COUNT];
+};
+
+_Static_assert(sizeof(struct PHTMBenchRequest) == 8, "PHTMBenchRequest layout changed");
+_Static_assert(sizeof(struct PHTMBenchPath) == 64, "PHTMBenchPath layout changed");
+_Static_assert(offsetof(struct PHTMBenchPath, iterations) == 16, "PHTMBenchPath layout changed");
+_Static_assert(offsetof(struct PHTMBenchPath, nsPerOp) == 24, "PHTMBenchPath layout changed");
+_Static_assert(offsetof(struct PHTMBenchPath, max) == 56, "PHTMBenchPath layout changed");
+_Static_assert(offsetof(struct PHTMBenchResult, paths) == 16, "PHTMBenchResult layout changed");
+_Static_assert(sizeof(struct PHTMBenchResult) == 272, "PHTMBenchResult layout changed");
+
+// Run Phantom's in-kernel self-benchmark and print the results
+// Usage: test-vmm bench [iterations] [dictSize], 0 or omitted uses the kext defaults
+static int runBench(int argc, const char * argv[]) {
+    struct PHTMBenchRequest request = {0, 0};
+    struct PHTMBenchResult result;
+    size_t len = sizeof(result);
+    const char* bench_sysctl_name = "debug.kpibench";
+
+    if (argc > 2) {
+        request.iterations = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        request.dictSize = (uint32_t)strtoul(argv[3], NULL, 10);
+    }
+
+    printf("Running %s (iterations: %u, dictSize: %u, 0 = default)...\n", bench_sysctl_name, request.iterations, request.dictSize);
+
+    if (sysctlbyname(bench_sysctl_name, &result, &len, &request, sizeof(request)) == -1) {
+        perror("Error calling sysctlbyname");
+        if (errno == ENOENT) {
+            printf("Sysctl '%s' does not exist. Phantom must be loaded and booted with -phtmbench.\n", bench_sysctl_name);
+        } else if (errno == EPERM) {
+            printf("Sysctl '%s' requires root, run with sudo.\n", bench_sysctl_name);
+        }
+        return 1; // Indicate an error
+    }
+
+    if (len != sizeof(result) || result.version != PHTM_BENCH_VERSION || result.pathCount > PHTM_BENCH_PATH_COUNT) {
+        printf("Sysctl '%s' returned an unexpected layout (length: %zu, version: %u).\n", bench_sysctl_name, len, result.version);
+        return 1; // Indicate an error
+    }
+
+    printf("Iterations: %u, KMP dictionary size: %u\n", result.iterations, result.dictSize);
+    printf("%-16s %10s %10s %10s %10s %10s %10s\n", "path", "iterations", "ns/op", "p50", "p90", "p99", "max");
+    for (uint32_t i = 0; i < result.pathCount; ++i) {
+        const struct PHTMBenchPath *path = &result.paths[i];
+        printf("%-16.*s %10u %10llu %10llu %10llu %10llu %10llu\n", PHTM_BENCH_PATH_NAME_LEN, path->name, path->iterations,
+               (unsigned long long)path->nsPerOp, (unsigned long long)path->p50, (unsigned long long)path->p90,
+               (unsigned long long)path->p99, (unsigned long long)path->max);
+    }
+
+    printf("test-vmm bench finished.\n");
+    return 0; // Indicate success
+}
 
 int main(int argc, const char * argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        return runBench(argc, argv);
+    }
+
     int vmm_present = 0;
     size_t len = sizeof(vmm_present);
     const char* vmm_sysctl_name = "kern.hv_vmm_present";